@@ -12,7 +12,8 @@
 
 namespace protomodel {
 
-inline std::string get_object_typename(const flatbuffers::StructDef *obj)
+inline std::string get_object_typename(const flatbuffers::StructDef *obj,
+                                       bool native = true)
 {
   std::string type_str;
   if (obj->defined_namespace)
@@ -21,7 +22,7 @@ inline std::string get_object_typename(const flatbuffers::StructDef *obj)
     { type_str += ns + "::"; }
   }
   type_str += obj->name;
-  if (! obj->fixed)
+  if ((! obj->fixed) && native)
   { type_str += 'T'; } /* FIXME 'T' may change */
 
   return type_str;
@@ -43,6 +44,8 @@ public:
       {"at_least", &TableValue<T>::at_least},
       {"at_most", &TableValue<T>::at_most},
       {"has_range", &TableValue<T>::has_range},
+      {"is_string", &TableValue<T>::is_string},
+      {"is_key", &TableValue<T>::is_key},
     });
   }
 
@@ -65,6 +68,12 @@ private:
   mstch::node has_range()
   { return std::is_integral<T>::value; }
 
+  mstch::node is_string()
+  { return std::is_same<T, std::string>::value; }
+
+  mstch::node is_key()
+  { return (_field->attributes.Lookup("key") != nullptr); }
+
   mstch::node type()
   { return TypeName<T>::name; }
 
@@ -88,6 +97,7 @@ public:
       {"key_type", &TableMap::key_type},
       {"value_type", &TableMap::value_type},
       {"value_obj_type", &TableMap::value_obj_type},
+      {"value_fb_type", &TableMap::value_fb_type},
       {"at_least", &TableMap::at_least},
       {"at_most", &TableMap::at_most},
     });
@@ -116,6 +126,9 @@ private:
   mstch::node value_obj_type()
   { return get_object_typename(_obj); }
 
+  mstch::node value_fb_type()
+  { return get_object_typename(_obj, false); }
+
   mstch::node value_type()
   { return _obj->name; }
 
@@ -144,6 +157,7 @@ public:
       {"py_name", &TableObject::py_name},
       {"type", &TableObject::type},
       {"obj_type", &TableObject::obj_type},
+      {"fb_type", &TableObject::fb_type},
       {"required", &TableObject::required},
       {"at_least", &TableObject::at_least},
       {"at_most", &TableObject::at_most},
@@ -163,6 +177,9 @@ private:
   mstch::node obj_type()
   { return get_object_typename(_obj); }
 
+  mstch::node fb_type()
+  { return get_object_typename(_obj, false); }
+
   mstch::node required()
   {
     if (_obj->fixed) /* 'struct' in the IDL */
@@ -199,6 +216,8 @@ public:
     register_methods(this, {
       {"table_name", &Table::name},
       {"table_type", &Table::type},
+      {"table_fb_type", &Table::fb_type},
+      {"table_namespace", &Table::ns},
       {"values", &Table::values},
       {"repeated_values", &Table::repeated_values},
       {"objects", &Table::objects},
@@ -232,6 +251,20 @@ private:
   mstch::node type()
   { return get_object_typename(_obj); }
 
+  mstch::node fb_type()
+  { return get_object_typename(_obj, false); }
+
+  mstch::node ns()
+  {
+    std::string ns_str;
+    if (_obj->defined_namespace)
+    {
+      for (const auto &ns : _obj->defined_namespace->components)
+      { ns_str += (ns_str.empty()) ? ns : "::" + ns; }
+    }
+    return ns_str;
+  }
+
   mstch::node values()
   { return _values; }
 
@@ -297,10 +330,15 @@ public:
     register_methods(this, {
       {"includes", &Context::includes},
       {"tables", &Context::tables},
+      {"sorted_tables", &Context::sorted_tables},
       {"root_type", &Context::root_type},
+      {"root_fb_type", &Context::root_fb_type},
       {"root_table", &Context::root_table},
+      {"root", &Context::root},
       {"model_name", &Context::model_name},
       {"magic", &Context::magic},
+      {"header", &Context::header},
+      {"headers", &Context::headers},
     });
   }
 
@@ -308,6 +346,18 @@ public:
   void add_include(const std::string &name)
   { _includes.emplace_back(std::make_shared<Include>(name)); }
 
+  /* The header changes with the template being rendered */
+  void set_header(const std::string &name)
+  { _header = name; }
+
+  /* Headers generated from each header template, by template name */
+  void set_headers(const std::map<std::string, std::string> &headers)
+  {
+    _headers.clear();
+    for (const auto &it : headers)
+    { _headers.emplace(it.first, it.second); }
+  }
+
   std::shared_ptr<Table> add_table(const flatbuffers::StructDef *obj)
   {
     auto msg = std::make_shared<Table>(obj);
@@ -315,6 +365,9 @@ public:
     return msg;
   }
 
+  void add_sorted_table(const std::shared_ptr<Table> &table)
+  { _sorted_tables.push_back(table); }
+
   Status load(const std::string &filename,
               const char *data,
               const std::vector<std::string> &include_dirs)
@@ -349,23 +402,42 @@ private:
   mstch::node magic()
   { return _parser.file_identifier_; }
 
+  mstch::node header()
+  { return _header; }
+
+  mstch::node headers()
+  { return _headers; }
+
   mstch::node root_table()
   { return _parser.root_struct_def_->name; }
 
   mstch::node root_type()
   { return get_object_typename(_parser.root_struct_def_); }
 
+  /* The root table is the first one to be explored */
+  mstch::node root()
+  { return (_tables.empty()) ? mstch::node{} : _tables.front(); }
+
+  mstch::node root_fb_type()
+  { return get_object_typename(_parser.root_struct_def_, false); }
+
   mstch::node includes()
   { return _includes; }
 
   mstch::node tables()
   { return _tables; }
 
+  mstch::node sorted_tables()
+  { return _sorted_tables; }
+
 private:
   const std::string _model_name;
   flatbuffers::Parser _parser;
   mstch::array _includes;
   mstch::array _tables;
+  mstch::array _sorted_tables;
+  std::string _header;
+  mstch::map _headers;
 };
 
 } /* namespace protomodel */
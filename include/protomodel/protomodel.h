@@ -3,6 +3,8 @@
 #ifndef PROTOMODEL_PROTMODEL_H__
 #define PROTOMODEL_PROTMODEL_H__
 
+#include <cstddef>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -30,6 +32,41 @@ std::shared_ptr<Context> load(const std::string &filename,
  */
 std::string get_model_name(const std::string &filename);
 
+/**
+ * Retrieve the header that goes with the source generated from a template.
+ *
+ * The header of the output of @p templates[index] is the output of the
+ * header template rendered along with it: for @c a-b.cpp.mustache, the
+ * output of @c a-b.h.mustache, or else of @c a.h.mustache. When no such
+ * template is rendered, the output of @p templates[index] is given an @c .h
+ * extension instead.
+ *
+ * @param[in] templates Templates being rendered
+ * @param[in] outputs Output file of each template
+ * @param[in] index Index of the template in @p templates
+ * @return The basename of the header
+ */
+std::string get_header_name(const std::vector<std::string> &templates,
+                            const std::vector<std::string> &outputs,
+                            size_t index);
+
+/**
+ * Retrieve the headers generated from the header templates.
+ *
+ * Each header template @c xxx.h.mustache of the directories of @p templates
+ * is associated to the basename of its output, when it is one of
+ * @p templates, or else to @c xxx.h. This lets the sources include the
+ * headers generated from other templates than their own.
+ *
+ * @param[in] templates Templates being rendered
+ * @param[in] outputs Output file of each template
+ * @return The basename of the header of each header template, by the name
+ *   of the template without its @c .h.mustache extension
+ */
+std::map<std::string, std::string>
+get_header_names(const std::vector<std::string> &templates,
+                 const std::vector<std::string> &outputs);
+
 /**
  * Transform a flatbuffer identifier into a pascal-case string.
  *
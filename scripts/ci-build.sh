@@ -12,6 +12,7 @@ mkdir build-debug
 cd build-debug
 cmake -DCMAKE_BUILD_TYPE=Debug -DCMAKE_INSTALL_PREFIX=_install ..
 cmake --build . --target install
+ctest --output-on-failure
 cd ..
 
 # Compile for Release
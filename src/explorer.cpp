@@ -111,6 +111,9 @@ _explore(std::shared_ptr<Context> &context,
   {
      ECHECK(_explore_type(context, table, obj, field));
   }
+
+  /* All the tables contained by this one have been explored */
+  context->add_sorted_table(table);
   return Ok();
 }
 
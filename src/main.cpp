@@ -7,6 +7,8 @@
 #include <cxxopts.hpp>
 #include <mstch/mstch.hpp>
 
+#include <map>
+#include <regex>
 #include <sstream>
 #include <istream>
 #include <fstream>
@@ -19,6 +21,34 @@
 
 namespace protomodel {
 
+/*
+ * Load the partials {{> name}} used by the template @p text, and the ones
+ * they use, from the files <name>.mustache of the directory @p dir
+ */
+static Status
+_load_partials(const std::string &dir, const std::string &text,
+              std::map<std::string, std::string> &partials)
+{
+  static const std::regex partial_tag{ R"(\{\{>\s*([^\s}]+)\s*\}\})" };
+  const std::sregex_iterator end;
+  for (std::sregex_iterator it{ text.begin(), text.end(), partial_tag }; it != end; ++it)
+  {
+    const std::string name = (*it)[1].str();
+    if (partials.count(name))
+    { continue; }
+
+    const std::string path = dir + name + ".mustache";
+    std::ifstream in_file{ path };
+    if (! in_file)
+    { return error("failed to open partial '" + path + "'"); }
+    std::stringstream buffer;
+    buffer << in_file.rdbuf();
+    partials[name] = buffer.str();
+    ECHECK(_load_partials(dir, partials[name], partials));
+  }
+  return Ok();
+}
+
 static Status
 run(int argc, char **argv)
 {
@@ -75,14 +105,24 @@ run(int argc, char **argv)
   { return error("protomodel context creation failed"); }
 
   assert(templates.size() == outputs.size());
+  context->set_headers(get_header_names(templates, outputs));
   for (size_t i = 0u; i < templates.size(); i++)
   {
     std::ifstream in_file{ templates[i] };
     std::stringstream buffer;
     buffer << in_file.rdbuf();
 
+    /* Partials are looked up next to the template */
+    const std::size_t slash = templates[i].rfind("/");
+    const std::string dir = (std::string::npos == slash) ? std::string{} :
+      templates[i].substr(0u, slash + 1u);
+    std::map<std::string, std::string> partials;
+    ECHECK(_load_partials(dir, buffer.str(), partials));
+
+    context->set_header(get_header_name(templates, outputs, i));
+
     std::ofstream outfile{ outputs[i] };
-    outfile << mstch::render(buffer.str(), context);
+    outfile << mstch::render(buffer.str(), context, partials);
     outfile.close();
   }
 
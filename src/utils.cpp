@@ -2,7 +2,10 @@
 
 #include "protomodel/protomodel.h"
 
+#include <filesystem>
+#include <map>
 #include <string>
+#include <vector>
 #include <cassert>
 #include <cstdint>
 
@@ -53,6 +56,94 @@ get_model_name(const std::string &filename)
   return filename.substr(start, end - start);
 }
 
+static std::string
+_basename(const std::string &filename)
+{
+  const std::size_t start = filename.rfind("/");
+  return (std::string::npos == start) ? filename : filename.substr(start + 1u);
+}
+
+std::string
+get_header_name(const std::vector<std::string> &templates,
+                const std::vector<std::string> &outputs,
+                size_t index)
+{
+  assert(templates.size() == outputs.size());
+  assert(index < templates.size());
+
+  /* Look for the header template of xxx-yyy.cpp.mustache, then of xxx */
+  static const std::string source_suffix{ ".cpp.mustache" };
+  std::string stem = _basename(templates[index]);
+  if ((stem.size() > source_suffix.size()) &&
+      (stem.compare(stem.size() - source_suffix.size(), std::string::npos,
+                    source_suffix) == 0))
+  {
+    stem.resize(stem.size() - source_suffix.size());
+    for (;;)
+    {
+      const std::string header = stem + ".h.mustache";
+      for (size_t i = 0u; i < templates.size(); i++)
+      {
+        if (_basename(templates[i]) == header)
+        { return _basename(outputs[i]); }
+      }
+
+      const std::size_t dash = stem.rfind("-");
+      if (std::string::npos == dash)
+      { break; }
+      stem.resize(dash);
+    }
+  }
+
+  /* Otherwise, the header is expected next to the output */
+  std::string output = _basename(outputs[index]);
+  const std::size_t dot = output.rfind(".");
+  if (std::string::npos != dot)
+  { output.resize(dot); }
+  return output + ".h";
+}
+
+std::map<std::string, std::string>
+get_header_names(const std::vector<std::string> &templates,
+                 const std::vector<std::string> &outputs)
+{
+  assert(templates.size() == outputs.size());
+
+  static const std::string header_suffix{ ".h.mustache" };
+  const auto stem_of = [](const std::string &name) {
+    if ((name.size() > header_suffix.size()) &&
+        (name.compare(name.size() - header_suffix.size(), std::string::npos,
+                      header_suffix) == 0))
+    { return name.substr(0u, name.size() - header_suffix.size()); }
+    return std::string{};
+  };
+
+  /* Headers that are not rendered keep the name of their template */
+  std::map<std::string, std::string> headers;
+  for (const auto &tmpl : templates)
+  {
+    std::filesystem::path dir = std::filesystem::path{ tmpl }.parent_path();
+    if (dir.empty())
+    { dir = "."; }
+
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator{ dir, error })
+    {
+      const std::string stem = stem_of(entry.path().filename().string());
+      if (! stem.empty())
+      { headers.emplace(stem, stem + ".h"); }
+    }
+  }
+
+  for (size_t i = 0u; i < templates.size(); i++)
+  {
+    const std::string stem = stem_of(_basename(templates[i]));
+    if (! stem.empty())
+    { headers[stem] = _basename(outputs[i]); }
+  }
+  return headers;
+}
+
 std::string
 get_pascal_case(const std::string &input)
 {
@@ -0,0 +1,63 @@
+/* Protomodel - MIT License */
+
+/*
+ * Compact loader: walking the descriptors of the tables must decode the
+ * configurations the unrolled loader decodes, and reject the others.
+ */
+
+#include "test.h"
+#include "toml-loader-compact.h"
+#include "object-compare.h"
+
+#include <string>
+#include <vector>
+
+static void
+_test_load()
+{
+  const auto cfg = protomodel::load(test::sample);
+  test::check((cfg.name == "sample") && (cfg.port == 8080) && (cfg.ratio > 0.2) && cfg.enabled,
+              "The values were not decoded");
+  test::check((cfg.levels == std::vector<int32_t>{ 1, 2, 3 }) && (cfg.tags.size() == 3u) &&
+              (cfg.tags[2] == "d\"e") && (cfg.ids[1] == 9223372036854775807u),
+              "The arrays of values were not decoded");
+  test::check(cfg.logging && (cfg.logging->level == "info") &&
+              (cfg.logging->sinks.size() == 1u) && (cfg.logging->sinks[0]->size == 4096u),
+              "The object was not decoded");
+  test::check((cfg.routes.size() == 2u) && (cfg.routes[1]->prio == -1),
+              "The array of objects was not decoded");
+
+  /* Entries of maps get their key, and are sorted by it */
+  test::check((cfg.servers.size() == 3u) && (cfg.servers[0]->name == "alpha") &&
+              (cfg.servers[1]->name == "beta") && (cfg.servers[2]->name == "with.dot") &&
+              (cfg.servers[0]->aliases.size() == 2u),
+              "The map was not decoded in order");
+
+  test::check(protomodel::load_from_buffer(test::read(test::sample)) == cfg,
+              "The buffer was not decoded as the file");
+}
+
+static void
+_test_errors()
+{
+  const auto load = [](const std::string &content) {
+    return [content]() { protomodel::load_from_buffer(content); };
+  };
+  test::check_throws(load("unknown = 1\n" + test::minimal), "Loading an unknown element");
+  test::check_throws(load("port = \"p\"\n" + test::minimal), "Loading a value of another type");
+  test::check_throws(load("port = 4294967296\n" + test::minimal), "Loading an out-of-range value");
+  test::check_throws(load(test::minimal.substr(test::minimal.find('\n') + 1u)), "Loading without a required value");
+  test::check_throws(load("name = \"n\"\n[[routes]]\npath = \"/\"\n"), "Loading empty arrays");
+  test::check_throws(load(test::minimal + "[logging]\nverbose = 3\n"), "Loading an invalid object");
+  test::check_throws([]() { protomodel::load("compact-missing.toml"); }, "Loading a missing file");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "load", _test_load },
+    { "errors", _test_errors },
+  });
+}
@@ -0,0 +1,82 @@
+/* Protomodel - MIT License */
+
+/*
+ * Comparison: objects holding the same values compare equal and hash alike,
+ * NaN included, and any value of any table makes them differ.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "object-compare.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+static void
+_test_equal()
+{
+  const auto a = protomodel::load(test::sample);
+  const auto b = protomodel::load(test::sample);
+  test::check((a == a) && (a == b) && ! (a != b), "Equal configurations differ");
+  test::check(protomodel::hash(a) == protomodel::hash(b), "Equal configurations hash differently");
+  test::check(protomodel::hash(*a.logging) == protomodel::hash(*b.logging),
+              "Equal tables hash differently");
+}
+
+static void
+_test_differ()
+{
+  const auto base = protomodel::load(test::sample);
+  const auto hash = protomodel::hash(base);
+
+  auto cfg = protomodel::load(test::sample);
+  cfg.routes[1]->prio = 7;
+  test::check((cfg != base) && (protomodel::hash(cfg) != hash), "The array of tables did not differ");
+
+  cfg = protomodel::load(test::sample);
+  cfg.servers[0]->aliases.push_back("x");
+  test::check((cfg != base) && (protomodel::hash(cfg) != hash), "The map did not differ");
+
+  cfg = protomodel::load(test::sample);
+  cfg.logging.reset();
+  test::check((cfg != base) && (protomodel::hash(cfg) != hash), "The absent table did not differ");
+
+  cfg = protomodel::load(test::sample);
+  cfg.curve.pop_back();
+  test::check((cfg != base) && (protomodel::hash(cfg) != hash), "The array of values did not differ");
+}
+
+static void
+_test_floats()
+{
+  auto a = protomodel::load(test::sample);
+  auto b = protomodel::load(test::sample);
+
+  /* NaN values do not make a configuration differ from itself */
+  a.ratio = std::numeric_limits<double>::quiet_NaN();
+  b.ratio = -std::numeric_limits<double>::quiet_NaN();
+  a.curve[1] = std::nanf("1");
+  b.curve[1] = std::numeric_limits<float>::quiet_NaN();
+  test::check(a == b, "NaN values differ");
+  test::check(protomodel::hash(a) == protomodel::hash(b), "NaN values hash differently");
+
+  a.ratio = -0.0;
+  b.ratio = 0.0;
+  test::check((a == b) && (protomodel::hash(a) == protomodel::hash(b)),
+              "Signed zeros differ");
+
+  b.ratio = std::numeric_limits<double>::quiet_NaN();
+  test::check(a != b, "A NaN value equals a number");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "equal", _test_equal },
+    { "differ", _test_differ },
+    { "floats", _test_floats },
+  });
+}
@@ -0,0 +1,115 @@
+/* Protomodel - MIT License */
+
+/*
+ * Difference: diff() reports each changed value at its path, matches the
+ * entries of maps by key and the elements of arrays of tables by position,
+ * and reports nothing for configurations that compare equal.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "object-diff.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Tell whether @p changes hold the change of @p path from @p from to @p to */
+static bool
+_has(const std::vector<protomodel::Change> &changes, const std::string &path,
+     const std::string &from, const std::string &to)
+{
+  return std::any_of(changes.begin(), changes.end(), [&](const protomodel::Change &change) {
+    return (change.path == path) && (change.old_value == from) && (change.new_value == to);
+  });
+}
+
+static void
+_test_equal()
+{
+  const auto a = protomodel::load(test::sample);
+  const auto b = protomodel::load(test::sample);
+  test::check(protomodel::diff(a, b).empty(), "Equal configurations differ");
+
+  /* NaN read twice is not a change */
+  auto c = protomodel::load(test::sample);
+  auto d = protomodel::load(test::sample);
+  c.ratio = std::numeric_limits<double>::quiet_NaN();
+  d.ratio = std::numeric_limits<double>::quiet_NaN();
+  c.logging->sinks[0]->size = 1u;
+  d.logging->sinks[0]->size = 1u;
+  test::check(protomodel::diff(c, d).empty(), "NaN values differ");
+}
+
+static void
+_test_values()
+{
+  const auto a = protomodel::load(test::sample);
+  auto b = protomodel::load(test::sample);
+  b.port = 9090;
+  b.levels.push_back(4);
+  b.logging->level = "debug";
+  b.logging->sinks[0]->size = 1u;
+  b.routes[1]->prio = 5;
+
+  const auto changes = protomodel::diff(a, b);
+  test::check(_has(changes, "port", "8080", "9090"), "The value was not reported");
+  test::check(_has(changes, "levels", "[1, 2, 3]", "[1, 2, 3, 4]"), "The array was not reported");
+  test::check(_has(changes, "logging.level", "\"info\"", "\"debug\""), "The table value was not reported");
+  test::check(_has(changes, "logging.sinks[0].size", "4096", "1"), "The nested value was not reported");
+  test::check(_has(changes, "routes[1].prio", "-1", "5"), "The element value was not reported");
+  test::check(changes.size() == 5u, "Unchanged values were reported");
+}
+
+static void
+_test_tables()
+{
+  const auto a = protomodel::load(test::sample);
+  auto b = protomodel::load(test::sample);
+  b.logging.reset();
+  b.routes.push_back(std::make_unique<sample::RouteT>());
+
+  const auto changes = protomodel::diff(a, b);
+  test::check(_has(changes, "logging", "{...}", ""), "The removed table was not reported");
+  test::check(_has(changes, "routes[2]", "", "{...}"), "The added element was not reported");
+  test::check(changes.size() == 2u, "Unchanged tables were reported");
+  test::check(_has(protomodel::diff(b, a), "logging", "", "{...}"), "The added table was not reported");
+}
+
+static void
+_test_map()
+{
+  const auto a = protomodel::load(test::sample);
+
+  /* Entries are matched by key, not by position */
+  const auto file = test::write("diff-map.toml",
+    test::read(test::sample) +
+    "[servers.aaa]\n"
+    "host = \"new.example\"\n"
+    "aliases = [\"n\"]\n");
+  auto b = protomodel::load(file);
+  b.servers.erase(std::find_if(b.servers.begin(), b.servers.end(),
+                               [](const auto &server) { return server->name == "with.dot"; }));
+  b.servers[1]->port = 10;
+
+  const auto changes = protomodel::diff(a, b);
+  test::check(b.servers[1]->name == "alpha", "The map was not sorted by key");
+  test::check(_has(changes, "servers.aaa", "", "{...}"), "The added entry was not reported");
+  test::check(_has(changes, "servers.\"with.dot\"", "{...}", ""), "The removed entry was not reported");
+  test::check(_has(changes, "servers.alpha.port", "1", "10"), "The entry value was not reported");
+  test::check(changes.size() == 3u, "Unchanged entries were reported");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "equal", _test_equal },
+    { "values", _test_values },
+    { "tables", _test_tables },
+    { "map", _test_map },
+  });
+}
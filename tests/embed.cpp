@@ -0,0 +1,52 @@
+/* Protomodel - MIT License */
+
+/*
+ * Embedding: the configuration baked into the test at build time by the
+ * embedding driver must be the packed sample configuration.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "flatbuffers-pack.h"
+#include "toml-embed.h"
+
+#include <cstring>
+#include <memory>
+
+static void
+_test_embedded()
+{
+  const uint8_t *const data = protomodel::embedded_config_data();
+  const size_t size = protomodel::embedded_config_size();
+  test::check(reinterpret_cast<uintptr_t>(data) % 16u == 0u,
+              "The embedded configuration is not aligned");
+
+  flatbuffers::Verifier verifier{ data, size };
+  test::check(sample::VerifyConfigBuffer(verifier), "The embedded configuration is invalid");
+  test::check(protomodel::embedded_config() == sample::GetConfig(data),
+              "The embedded configuration is not at the root of its buffer");
+}
+
+static void
+_test_content()
+{
+  const auto buffer = protomodel::pack(protomodel::load(test::sample));
+  test::check((buffer.size() == protomodel::embedded_config_size()) &&
+              (std::memcmp(buffer.data(), protomodel::embedded_config_data(), buffer.size()) == 0),
+              "The embedded configuration is not the packed sample");
+
+  const sample::Config *const cfg = protomodel::embedded_config();
+  test::check((cfg->name()->str() == "sample") && (cfg->port() == 8080) &&
+              (cfg->servers()->size() == 3u) && (cfg->routes()->size() == 2u),
+              "The embedded configuration does not hold the sample");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "embedded", _test_embedded },
+    { "content", _test_content },
+  });
+}
@@ -0,0 +1,86 @@
+/* Protomodel - MIT License */
+
+/*
+ * Generator: the configurations generate() writes must be accepted by
+ * load(), be reproducible from their seed, and follow the options.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "toml-generator.h"
+
+#include <cstdio>
+#include <string>
+
+/* Generate the configuration of @p options into @p file */
+static protomodel::GeneratorStats
+_generate(const std::string &file, const protomodel::GeneratorOptions &options)
+{
+  std::FILE *const out = std::fopen(file.c_str(), "wb");
+  test::check(out != nullptr, "Failed to open " + file);
+  const auto stats = protomodel::generate(options, out);
+  test::check(std::fclose(out) == 0, "Failed to write " + file);
+  return stats;
+}
+
+static void
+_test_accepted()
+{
+  protomodel::GeneratorOptions options;
+  options.scale = 50u;
+  for (options.seed = 0u; options.seed < 20u; options.seed++)
+  {
+    const std::string file = "generator-" + std::to_string(options.seed) + ".toml";
+    const auto stats = _generate(file, options);
+    test::check(stats.bytes == test::read(file).size(), "The size of the document is wrong");
+    test::check(stats.tables >= 1u, "The root table was not counted");
+    protomodel::load(file);
+  }
+}
+
+static void
+_test_seed()
+{
+  protomodel::GeneratorOptions options;
+  options.scale = 20u;
+  options.seed = 42u;
+  _generate("generator-a.toml", options);
+  _generate("generator-b.toml", options);
+  test::check(test::read("generator-a.toml") == test::read("generator-b.toml"),
+              "The same seed generated different configurations");
+  options.seed = 43u;
+  _generate("generator-c.toml", options);
+  test::check(test::read("generator-a.toml") != test::read("generator-c.toml"),
+              "Different seeds generated the same configuration");
+}
+
+static void
+_test_options()
+{
+  /* Optional elements are all present, or all absent */
+  protomodel::GeneratorOptions options;
+  options.scale = 10u;
+  options.percent = 100u;
+  _generate("generator-all.toml", options);
+  const auto all = protomodel::load("generator-all.toml");
+  test::check(all.logging && (all.logging->sinks.size() >= 1u), "Optional elements are missing");
+
+  options.percent = 0u;
+  _generate("generator-none.toml", options);
+  const auto none = protomodel::load("generator-none.toml");
+  test::check((! none.logging) && (none.port == 0), "Optional elements are present");
+  test::check((none.routes.size() >= 1u) && (none.routes.size() <= 10u) &&
+              (none.servers.size() >= 1u) && (none.servers.size() <= 10u),
+              "The root arrays do not follow the scale");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "accepted", _test_accepted },
+    { "seed", _test_seed },
+    { "options", _test_options },
+  });
+}
@@ -0,0 +1,101 @@
+/* Protomodel - MIT License */
+
+/*
+ * Layered configurations: the layers following the base one replace its
+ * values and arrays, and are merged into its tables and maps. A
+ * LayeredLoader shares the configurations of unchanged layers.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "toml-loader-layered.h"
+
+#include <string>
+#include <vector>
+
+static const std::string override_layer{
+  "port = 9090\n"
+  "levels = [7]\n"
+  "[logging]\n"
+  "level = \"debug\"\n"
+  "[[routes]]\n"
+  "path = \"/z\"\n"
+  "[servers.alpha]\n"
+  "port = 11\n"
+  "[servers.gamma]\n"
+  "host = \"g.example\"\n"
+  "aliases = [\"g\"]\n"
+};
+
+static void
+_check_layered(const sample::ConfigT &cfg)
+{
+  const auto base = protomodel::load(test::sample);
+
+  /* Values and arrays are replaced */
+  test::check((cfg.port == 9090) && (cfg.levels == std::vector<int32_t>{ 7 }),
+              "The values were not replaced");
+  test::check((cfg.name == base.name) && (cfg.tags == base.tags),
+              "The values of the base were not kept");
+  test::check((cfg.routes.size() == 1u) && (cfg.routes[0]->path == "/z"),
+              "The array of tables was not replaced");
+
+  /* Tables are merged */
+  test::check(cfg.logging && (cfg.logging->level == "debug") &&
+              (cfg.logging->verbose == base.logging->verbose) &&
+              (cfg.logging->sinks.size() == base.logging->sinks.size()),
+              "The table was not merged");
+
+  /* Maps are merged by key, and stay sorted */
+  test::check(cfg.servers.size() == 4u, "The map was not merged");
+  const auto *const alpha = protomodel::find_Config_servers(cfg, "alpha");
+  const auto *const gamma = protomodel::find_Config_servers(cfg, "gamma");
+  test::check(alpha && (alpha->port == 11) && (alpha->host == "a.example") &&
+              (alpha->aliases.size() == 2u),
+              "The map entry was not merged");
+  test::check(gamma && (gamma->host == "g.example") && (cfg.servers[2].get() == gamma),
+              "The map entry was not added in order");
+}
+
+static void
+_test_load_layered()
+{
+  const auto layer = test::write("layered-override.toml", override_layer);
+  _check_layered(protomodel::load_layered({ test::sample, layer }));
+  test::check_throws([]() { protomodel::load_layered({}); }, "Loading without layers");
+  test::check_throws([&]() {
+    protomodel::load_layered({ test::sample, test::write("layered-bad.toml", "unknown = 1\n") });
+  }, "Loading an invalid layer");
+}
+
+static void
+_test_layered_loader()
+{
+  protomodel::LayeredLoader loader;
+  const auto layer = test::write("layered-loader.toml", override_layer);
+
+  const auto base = loader.load({ test::sample });
+  test::check(loader.load({ test::sample }) == base, "The base configuration was not shared");
+
+  const auto cfg = loader.load({ test::sample, layer });
+  _check_layered(*cfg);
+  test::check(loader.load({ test::sample, layer }) == cfg, "The configuration was not shared");
+  test::check(base->port == 8080, "Applying the layers changed the base configuration");
+
+  /* A changed layer is applied again over the base */
+  test::write(layer, "ratio = 0.75\n" + override_layer);
+  const auto changed = loader.load({ test::sample, layer });
+  test::check((changed != cfg) && (changed->ratio > 0.7) && (changed->port == 9090),
+              "The changed layer was not applied");
+  test::check(cfg->ratio < 0.3, "A previous configuration was changed");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "load_layered", _test_load_layered },
+    { "layered_loader", _test_layered_loader },
+  });
+}
@@ -0,0 +1,87 @@
+/* Protomodel - MIT License */
+
+/*
+ * Lazy configurations: the values of the root table are decoded up front,
+ * its tables only by their first access, once, even when threads access
+ * them concurrently.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "toml-loader-lazy.h"
+#include "object-compare.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void
+_test_lazy()
+{
+  const auto loaded = protomodel::load(test::sample);
+  const protomodel::LazyConfig lazy{ test::sample };
+  const auto &cfg = lazy.config();
+  test::check((cfg.name == loaded.name) && (cfg.port == loaded.port) &&
+              (cfg.levels == loaded.levels),
+              "The values of the root table were not decoded");
+  test::check((! cfg.logging) && cfg.routes.empty() && cfg.servers.empty(),
+              "Tables were decoded before their access");
+
+  test::check(lazy.logging() && (*lazy.logging() == *loaded.logging),
+              "The object was not decoded");
+  test::check(lazy.logging() == cfg.logging.get(), "The object was decoded twice");
+  test::check(lazy.routes().size() == loaded.routes.size(), "The repeated object was not decoded");
+  test::check((lazy.servers().size() == 3u) && (lazy.servers()[0]->name == "alpha"),
+              "The map was not decoded in order");
+  test::check(cfg == loaded, "The configuration differs from a load");
+}
+
+static void
+_test_absent()
+{
+  const protomodel::LazyConfig lazy{ test::write("lazy-minimal.toml", test::minimal) };
+  test::check(! lazy.logging(), "An absent object was decoded");
+  test::check(lazy.servers().size() == 1u, "The map was not decoded");
+}
+
+static void
+_test_errors()
+{
+  test::check_throws([]() {
+    protomodel::LazyConfig{ test::write("lazy-root.toml", "port = \"p\"\n" + test::minimal) };
+  }, "Loading an invalid value of the root table");
+
+  /* Errors within tables are only reported by their accessor */
+  const protomodel::LazyConfig lazy{
+    test::write("lazy-table.toml", test::minimal + "[logging]\nverbose = 3\n") };
+  test::check_throws([&]() { lazy.logging(); }, "Accessing an invalid object");
+  test::check(lazy.servers().size() == 1u, "The valid map was not decoded");
+}
+
+static void
+_test_concurrent()
+{
+  const protomodel::LazyConfig lazy{ test::sample };
+  std::vector<const std::vector<std::unique_ptr<sample::ServerT>> *> seen(4u);
+  std::vector<std::thread> threads;
+  for (size_t i = 0u; i < seen.size(); i++)
+  { threads.emplace_back([&, i]() { seen[i] = &lazy.servers(); }); }
+  for (auto &thread : threads)
+  { thread.join(); }
+
+  for (const auto *servers : seen)
+  { test::check((servers == seen[0]) && (servers->size() == 3u), "The map was decoded twice"); }
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "lazy", _test_lazy },
+    { "absent", _test_absent },
+    { "errors", _test_errors },
+    { "concurrent", _test_concurrent },
+  });
+}
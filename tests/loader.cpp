@@ -0,0 +1,227 @@
+/* Protomodel - MIT License */
+
+/*
+ * Loader: the options of load() and its other entry points must decode the
+ * configurations load() decodes on its own.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "object-compare.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* Memory resource counting the allocations made from it */
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  size_t allocations = 0u;
+
+private:
+  void *do_allocate(size_t bytes, size_t alignment) override
+  {
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override
+  { std::pmr::new_delete_resource()->deallocate(p, bytes, alignment); }
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+  { return this == &other; }
+};
+
+static void
+_test_resource()
+{
+  /* The resource only backs the bookkeeping of the loader */
+  CountingResource resource;
+  protomodel::LoadOptions options;
+  options.resource = &resource;
+  test::check(protomodel::load(test::sample, options) == protomodel::load(test::sample),
+              "The configuration differs from a load");
+  test::check(resource.allocations != 0u, "The resource was not used");
+}
+
+static void
+_test_load_many()
+{
+  const std::vector<std::string> files{
+    test::sample,
+    test::write("loader-many-invalid.toml", "port = 1\n"),
+    test::write("loader-many-minimal.toml", test::minimal),
+    "loader-many-missing.toml",
+  };
+  const auto sample = protomodel::load(test::sample);
+  for (const unsigned int threads : { 0u, 1u, 3u, 8u })
+  {
+    const auto results = protomodel::load_many(files, threads);
+    test::check(results.size() == files.size(), "Files were not all loaded");
+    test::check(results[0].error.empty() && (results[0].config == sample),
+                "The sample was not loaded");
+    test::check(! results[1].error.empty(), "The invalid file was loaded");
+    test::check(results[2].error.empty() && (results[2].config.name == "minimal"),
+                "The results are not in the order of the files");
+    test::check(! results[3].error.empty(), "The missing file was loaded");
+  }
+  test::check(protomodel::load_many({}, 0u).empty(), "Loading no file loaded some");
+}
+
+/* Sample configuration holding @p count routes, the ones at @p extra holding
+ * the unknown element named after their index */
+static std::string
+_routes(size_t count, const std::vector<size_t> &extra = {})
+{
+  std::string content{ test::minimal.substr(0u, test::minimal.find("[[routes]]")) };
+  for (size_t i = 0u; i < count; i++)
+  {
+    content += "[[routes]]\npath = \"/" + std::to_string(i) + "\"\nprio = " + std::to_string(i) + "\n";
+    if (std::find(extra.begin(), extra.end(), i) != extra.end())
+    { content += "unknown" + std::to_string(i) + " = 1\n"; }
+  }
+  return content + "[servers.s]\naliases = [\"a\"]\n";
+}
+
+static void
+_test_parallel()
+{
+  const auto file = test::write("loader-parallel.toml", _routes(1000u));
+  protomodel::LoadOptions options;
+  options.threads = 4u;
+  options.parallel_threshold = 16u;
+  const auto cfg = protomodel::load(file, options);
+  test::check(cfg == protomodel::load(file), "The parallel load differs from a serial one");
+  test::check(cfg.routes.size() == 1000u, "Elements were not all decoded");
+  for (size_t i = 0u; i < cfg.routes.size(); i++)
+  {
+    test::check((cfg.routes[i]->path == "/" + std::to_string(i)) &&
+                (cfg.routes[i]->prio == static_cast<int64_t>(i)),
+                "The elements are not in order");
+  }
+
+  /* The error of the first failing element is reported */
+  const auto invalid = test::write("loader-parallel-invalid.toml", _routes(1000u, { 700u, 300u }));
+  for (const unsigned int threads : { 0u, 4u })
+  {
+    options.threads = threads;
+    std::string error;
+    try
+    { protomodel::load(invalid, options); }
+    catch (const std::exception &e)
+    { error = e.what(); }
+    test::check(error.find("unknown300") != std::string::npos,
+                "The error is not the one of the first failing element");
+  }
+}
+
+static void
+_test_find()
+{
+  const auto cfg = protomodel::load(test::sample);
+  for (const char *key : { "alpha", "beta", "with.dot" })
+  {
+    const auto *const found = protomodel::find_Config_servers(cfg, key);
+    test::check(found && (found->name == key), std::string{ "Failed to find " } + key);
+  }
+  test::check(! protomodel::find_Config_servers(cfg, "gamma") &&
+              ! protomodel::find_Config_servers(cfg, "") &&
+              ! protomodel::find_Config_servers(cfg, "alph"),
+              "Found an absent key");
+
+  /* The index finds the elements the binary search finds */
+  const protomodel::ConfigServersIndex index{ cfg.servers };
+  for (const auto &server : cfg.servers)
+  { test::check(index.find(server->name) == server.get(), "The index did not find " + server->name); }
+  test::check(! index.find("gamma") && ! index.find(""), "The index found an absent key");
+
+  /* Many keys share probe sequences */
+  sample::ConfigT large;
+  for (size_t i = 0u; i < 1000u; i++)
+  {
+    large.servers.push_back(std::make_unique<sample::ServerT>());
+    large.servers.back()->name = "s" + std::to_string(i);
+  }
+  const protomodel::ConfigServersIndex large_index{ large.servers };
+  for (const auto &server : large.servers)
+  { test::check(large_index.find(server->name) == server.get(), "The index did not find " + server->name); }
+  test::check(! large_index.find("s1000"), "The index found an absent key");
+  test::check(! protomodel::ConfigServersIndex{ sample::ConfigT{}.servers }.find("s"),
+              "The empty index found a key");
+}
+
+static void
+_test_buffer()
+{
+  const auto sample = protomodel::load(test::sample);
+  const std::string content = test::read(test::sample);
+  test::check(protomodel::load_from_buffer(content) == sample, "The buffer differs from the file");
+
+  /* Only the view is parsed, not what follows it */
+  const std::string padded = content + "unknown = 1\n";
+  test::check(protomodel::load_from_buffer(std::string_view{ padded }.substr(0u, content.size())) == sample,
+              "The data following the view was parsed");
+  test::check_throws([&]() { protomodel::load_from_buffer(padded); }, "Loading an invalid buffer");
+}
+
+static void
+_test_fd()
+{
+  const auto sample = protomodel::load(test::sample);
+
+  /* Regular files are read from their current offset */
+  const std::string header = "# header\n";
+  const auto file = test::write("loader-fd.toml", header + test::read(test::sample));
+  const int fd = open(file.c_str(), O_RDONLY);
+  test::check(fd >= 0, "Failed to open " + file);
+  test::check(lseek(fd, static_cast<off_t>(header.size()), SEEK_SET) >= 0, "Failed to seek");
+  const auto cfg = protomodel::load_from_fd(fd);
+  test::check(fcntl(fd, F_GETFD) != -1, "The descriptor was closed");
+  close(fd);
+  test::check(cfg == sample, "The file descriptor differs from the file");
+
+  /* Pipes are read until their end */
+  int fds[2];
+  test::check(pipe(fds) == 0, "Failed to create a pipe");
+  std::thread writer{ [&]() {
+    const std::string content = test::read(test::sample);
+    for (size_t written = 0u; written < content.size();)
+    {
+      const ssize_t ret = write(fds[1], content.data() + written, content.size() - written);
+      if (ret <= 0)
+      { break; }
+      written += static_cast<size_t>(ret);
+    }
+    close(fds[1]);
+  } };
+  const auto piped = protomodel::load_from_fd(fds[0]);
+  writer.join();
+  close(fds[0]);
+  test::check(piped == sample, "The pipe differs from the file");
+
+  test::check_throws([]() { protomodel::load_from_fd(-1); }, "Loading an invalid descriptor");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "resource", _test_resource },
+    { "load_many", _test_load_many },
+    { "parallel", _test_parallel },
+    { "find", _test_find },
+    { "buffer", _test_buffer },
+    { "fd", _test_fd },
+  });
+}
@@ -0,0 +1,236 @@
+/* Protomodel - MIT License */
+
+/*
+ * Native types: a configuration loaded as native types must hold the same
+ * values as when it is loaded in the flatbuffers object API, and copies of
+ * it must be independent of it. The test is built for each string storage
+ * of the native types.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "toml-native.h"
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+using NativeConfig = protomodel::native::sample::Config;
+
+#ifdef PROTOMODEL_NATIVE_STRING_VIEWS
+/* Strings of all the configurations of the test */
+static protomodel::native::StringArena _arena;
+#endif
+
+static NativeConfig
+_load_native(const std::string &file)
+{
+#ifdef PROTOMODEL_NATIVE_STRING_VIEWS
+  return protomodel::native::load(file, _arena);
+#else
+  return protomodel::native::load(file);
+#endif
+}
+
+/* Native strings compare with std::string, whatever their type */
+template<typename T, typename U>
+static bool
+_same(const T &a, const U &b)
+{
+  if constexpr (std::is_convertible<const T &, std::string_view>::value)
+  { return std::string_view{ a } == std::string_view{ b }; }
+  else
+  { return a == b; }
+}
+
+template<typename T, typename U>
+static bool
+_same_values(const T &a, const U &b)
+{
+  if (a.size() != b.size())
+  { return false; }
+  for (size_t i = 0u; i < a.size(); i++)
+  {
+    if (! _same(a[i], b[i]))
+    { return false; }
+  }
+  return true;
+}
+
+static void
+_check_same(const NativeConfig &native, const sample::ConfigT &cfg)
+{
+  test::check(_same(native.name, cfg.name), "name differs");
+  test::check(native.port == cfg.port, "port differs");
+  test::check(native.ratio <= cfg.ratio && native.ratio >= cfg.ratio, "ratio differs");
+  test::check(native.enabled == cfg.enabled, "enabled differs");
+  test::check(_same_values(native.levels, cfg.levels), "levels differ");
+  test::check(_same_values(native.tags, cfg.tags), "tags differ");
+  test::check(_same_values(native.ids, cfg.ids), "ids differ");
+  test::check(native.curve.size() == cfg.curve.size(), "curve differs");
+  for (size_t i = 0u; i < cfg.curve.size(); i++)
+  { test::check(native.curve[i] <= cfg.curve[i] && native.curve[i] >= cfg.curve[i], "curve differs"); }
+
+  test::check(native.logging.has_value() == static_cast<bool>(cfg.logging), "logging differs");
+  if (cfg.logging)
+  {
+    test::check(_same(native.logging->level, cfg.logging->level), "logging.level differs");
+    test::check(native.logging->verbose == cfg.logging->verbose, "logging.verbose differs");
+    test::check(native.logging->sinks.size() == cfg.logging->sinks.size(), "logging.sinks differ");
+    for (size_t i = 0u; i < cfg.logging->sinks.size(); i++)
+    {
+      test::check(_same(native.logging->sinks[i].path, cfg.logging->sinks[i]->path) &&
+                  (native.logging->sinks[i].size == cfg.logging->sinks[i]->size),
+                  "logging.sinks differ");
+    }
+  }
+
+  test::check(native.routes.size() == cfg.routes.size(), "routes differ");
+  for (size_t i = 0u; i < cfg.routes.size(); i++)
+  {
+    test::check(_same(native.routes[i].path, cfg.routes[i]->path) &&
+                (native.routes[i].weight == cfg.routes[i]->weight) &&
+                (native.routes[i].prio == cfg.routes[i]->prio),
+                "routes differ");
+  }
+
+  test::check(native.servers.size() == cfg.servers.size(), "servers differ");
+  for (size_t i = 0u; i < cfg.servers.size(); i++)
+  {
+    test::check(_same(native.servers[i].name, cfg.servers[i]->name) &&
+                _same(native.servers[i].host, cfg.servers[i]->host) &&
+                (native.servers[i].port == cfg.servers[i]->port) &&
+                _same_values(native.servers[i].aliases, cfg.servers[i]->aliases),
+                "servers differ");
+  }
+}
+
+static void
+_test_load()
+{
+  _check_same(_load_native(test::sample), protomodel::load(test::sample));
+}
+
+static void
+_test_sorted_map()
+{
+  const NativeConfig native = _load_native(test::sample);
+  test::check(native.servers.size() == 3u, "servers were not all loaded");
+  test::check((native.servers[0].name == "alpha") && (native.servers[1].name == "beta") &&
+              (native.servers[2].name == "with.dot"),
+              "servers are not sorted by key");
+}
+
+static void
+_test_copy()
+{
+  const NativeConfig native = _load_native(test::sample);
+  NativeConfig copy = native;
+  test::check(copy.logging.has_value() && (&*copy.logging != &*native.logging),
+              "The copy shares its optional table");
+
+  copy.logging->verbose = ! copy.logging->verbose;
+  copy.routes[0].weight++;
+  copy.levels.push_back(42);
+  _check_same(native, protomodel::load(test::sample));
+
+  NativeConfig moved = std::move(copy);
+  test::check(moved.logging.has_value() && (moved.levels.back() == 42),
+              "Moving lost the configuration");
+}
+
+static void
+_test_optional()
+{
+  const auto file = test::write("native-optional.toml", test::minimal);
+  const NativeConfig native = _load_native(file);
+  test::check((native.name == "minimal") && (! native.logging.has_value()) &&
+              (native.port == 0) && (! native.enabled),
+              "Absent elements were loaded");
+}
+
+#ifdef PROTOMODEL_NATIVE_STRING_VIEWS
+static void
+_test_arena()
+{
+  /* Strings larger than a block are stored apart, and views stay valid */
+  const std::string large(100000u, 'x');
+  protomodel::native::StringArena arena;
+  const std::string_view small = arena.store("small");
+  const std::string_view stored = arena.store(large);
+  test::check((stored == large) && (stored.data() != large.data()), "The large string was not stored");
+  test::check((small == "small") && (arena.store("next") == "next"), "The blocks were not kept");
+
+  const NativeConfig native = protomodel::native::load(test::sample, arena);
+  const NativeConfig copy = native;
+  test::check((copy.tags[2] == "d\"e") && (copy.tags[2].data() == native.tags[2].data()),
+              "The copy does not view the strings of the arena");
+}
+#endif
+
+#ifdef PROTOMODEL_NATIVE_PMR
+static void
+_test_resource()
+{
+  /* The whole configuration is allocated from the resource given to load() */
+  std::pmr::monotonic_buffer_resource resource;
+#ifdef PROTOMODEL_NATIVE_STRING_VIEWS
+  const NativeConfig native = protomodel::native::load(test::sample, _arena, &resource);
+#else
+  const NativeConfig native = protomodel::native::load(test::sample, &resource);
+  test::check(native.name.get_allocator().resource() == &resource, "The string was not allocated from the resource");
+#endif
+  test::check((native.tags.get_allocator().resource() == &resource) &&
+              (native.logging->sinks.get_allocator().resource() == &resource) &&
+              (native.servers.get_allocator().resource() == &resource) &&
+              (native.servers[0].aliases.get_allocator().resource() == &resource),
+              "The configuration was not allocated from the resource");
+  _check_same(native, protomodel::load(test::sample));
+
+  /* Copies use the default resource, unless they are given one */
+  const NativeConfig copy = native;
+  test::check(copy.tags.get_allocator().resource() == std::pmr::get_default_resource(),
+              "The copy was allocated from the resource of the original");
+  std::pmr::monotonic_buffer_resource other;
+  const NativeConfig moved{ NativeConfig{ native }, &other };
+  test::check((moved.servers.get_allocator().resource() == &other) &&
+              (moved.servers[0].aliases.get_allocator().resource() == &other),
+              "The configuration was not moved to the other resource");
+  _check_same(moved, protomodel::load(test::sample));
+}
+#endif
+
+static void
+_test_errors()
+{
+  test::check_throws([]() {
+    _load_native(test::write("native-unknown.toml", "unknown = 1\n" + test::minimal));
+  }, "Loading an unknown element");
+  test::check_throws([]() {
+    _load_native(test::write("native-missing.toml", "port = 1\n"));
+  }, "Loading without a required element");
+  test::check_throws([]() {
+    _load_native(test::write("native-range.toml", "port = 4294967296\n" + test::minimal));
+  }, "Loading an out of range value");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "load", _test_load },
+    { "sorted_map", _test_sorted_map },
+    { "copy", _test_copy },
+    { "optional", _test_optional },
+#ifdef PROTOMODEL_NATIVE_STRING_VIEWS
+    { "arena", _test_arena },
+#endif
+#ifdef PROTOMODEL_NATIVE_PMR
+    { "resource", _test_resource },
+#endif
+    { "errors", _test_errors },
+  });
+}
@@ -0,0 +1,71 @@
+/* Protomodel - MIT License */
+
+/*
+ * Packing: a packed configuration unpacks to the one it was packed from,
+ * and patch() updates a packed configuration in place only when scalar
+ * values changed, NaN being no change.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "flatbuffers-pack.h"
+#include "object-compare.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+
+static std::unique_ptr<sample::ConfigT>
+_unpack(const flatbuffers::DetachedBuffer &buf)
+{ return std::unique_ptr<sample::ConfigT>{ sample::GetConfig(buf.data())->UnPack() }; }
+
+static void
+_test_pack()
+{
+  const auto cfg = protomodel::load(test::sample);
+  const auto buf = protomodel::pack(cfg);
+  flatbuffers::Verifier verifier{ buf.data(), buf.size() };
+  test::check(sample::VerifyConfigBuffer(verifier), "The packed configuration is invalid");
+  test::check(*_unpack(buf) == cfg, "The packed configuration differs");
+}
+
+static void
+_test_patch()
+{
+  auto cfg = protomodel::load(test::sample);
+  flatbuffers::DetachedBuffer buf;
+  test::check(! protomodel::patch(buf, cfg), "An empty buffer was patched");
+  test::check(*_unpack(buf) == cfg, "The empty buffer was not packed");
+
+  /* Scalars are overwritten in place, even the ones that held their default */
+  const uint8_t *const data = buf.data();
+  cfg.port = 9090;
+  cfg.routes[1]->prio = 0;
+  cfg.servers[0]->port = 7;
+  test::check(protomodel::is_patchable(buf.data(), cfg), "Changed scalars are not patchable");
+  test::check(protomodel::patch(buf, cfg) && (buf.data() == data), "The scalars were not patched");
+  test::check(*_unpack(buf) == cfg, "The patched configuration differs");
+
+  /* NaN is packed, then patched without being a change */
+  cfg.ratio = std::numeric_limits<double>::quiet_NaN();
+  cfg.curve[0] = std::numeric_limits<float>::quiet_NaN();
+  test::check(! protomodel::patch(buf, cfg), "The array of values was patched");
+  cfg.port = 1;
+  test::check(protomodel::is_patchable(buf.data(), cfg), "NaN values are not patchable");
+  test::check(protomodel::patch(buf, cfg) && (*_unpack(buf) == cfg), "NaN values were not patched");
+
+  /* Other changes pack the configuration again */
+  cfg.servers[0]->host = "other.example";
+  test::check(! protomodel::is_patchable(buf.data(), cfg), "A changed string is patchable");
+  test::check(! protomodel::patch(buf, cfg) && (*_unpack(buf) == cfg), "The string was not packed");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "pack", _test_pack },
+    { "patch", _test_patch },
+  });
+}
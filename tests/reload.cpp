@@ -0,0 +1,195 @@
+/* Protomodel - MIT License */
+
+/*
+ * Incremental reloads: a reload must produce the configuration a load of the
+ * same file produces, report the paths that changed, and reuse the tables
+ * that did not. The configurations published to a ConfigHandle must stay
+ * intact across the reloads that follow.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "toml-loader-reload.h"
+#include "object-compare.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* The sample configuration, with @p from replaced by @p to */
+static std::string
+_edit(const std::string &file, const std::string &from, const std::string &to)
+{
+  std::string content = test::read(test::sample);
+  const size_t pos = content.find(from);
+  test::check(pos != std::string::npos, "The sample has no '" + from + "'");
+  content.replace(pos, from.size(), to);
+  return test::write(file, content);
+}
+
+static void
+_check_loaded(const sample::ConfigT &cfg, const std::string &file)
+{
+  const auto loaded = protomodel::load(file);
+  test::check(cfg == loaded, "The reload differs from a load of '" + file + "'");
+}
+
+static void
+_test_reload()
+{
+  protomodel::Reloader reloader;
+  const auto first = reloader.reload(test::sample);
+  test::check(first.config && (first.changed.size() == 11u), "The first reload did not report all the elements");
+  const auto *const sinks = first.config->logging->sinks[0].get();
+  const auto *const alpha = first.config->servers[0].get();
+
+  const auto file = _edit("reload-route.toml", "weight = 2", "weight = 5");
+  const auto next = reloader.reload(file);
+  test::check((next.changed == std::vector<std::string>{ "routes[1].weight" }),
+              "The changed paths are wrong");
+  _check_loaded(*next.config, file);
+  test::check((next.config->logging->sinks[0].get() == sinks) &&
+              (next.config->servers[0].get() == alpha),
+              "The unchanged tables were not reused");
+
+  const auto same = reloader.reload(file);
+  test::check((same.config == next.config) && same.changed.empty(),
+              "Reloading an unchanged file changed the configuration");
+}
+
+static void
+_test_reload_error()
+{
+  protomodel::Reloader reloader;
+  const auto first = reloader.reload(test::sample);
+  const auto bad = _edit("reload-bad.toml", "port = 8080", "port = \"bad\"");
+  test::check_throws([&]() { reloader.reload(bad); }, "Reloading an invalid file");
+  test::check(reloader.config() == first.config, "A failed reload replaced the configuration");
+  _check_loaded(*reloader.config(), test::sample);
+
+  /* The tables shared with the failed reload still belong to it */
+  const auto file = _edit("reload-error.toml", "level = \"info\"", "level = \"warn\"");
+  _check_loaded(*reloader.reload(file).config, file);
+}
+
+static void
+_test_reload_copy()
+{
+  protomodel::Reloader reloader;
+  auto first = reloader.reload_copy(test::sample);
+  const auto *const published = first.get();
+  protomodel::ConfigHandle handle{ std::move(first) };
+
+  std::vector<std::string> changed;
+  const auto file = _edit("reload-copy.toml", "port = 2", "port = 22");
+  auto cfg = reloader.reload_copy(file, &changed);
+  test::check(cfg && (changed == std::vector<std::string>{ "servers.beta.port" }),
+              "The changed paths are wrong");
+  test::check((cfg->logging.get() != published->logging.get()) &&
+              (cfg->servers[0].get() != published->servers[0].get()),
+              "The copy shares tables with the published configuration");
+  _check_loaded(*cfg, file);
+  _check_loaded(*published, test::sample);
+  test::check(reloader.config() == cfg.get(), "The copy is not the current configuration");
+
+  handle.publish(std::move(cfg));
+  test::check(! reloader.reload_copy(file), "Reloading an unchanged file changed the configuration");
+}
+
+/*
+ * The tables contained in copied ones are reused from their copy: the
+ * previous configuration is released when the next one is published
+ */
+static void
+_test_reload_copy_published()
+{
+  protomodel::Reloader reloader;
+  protomodel::ConfigHandle handle{ reloader.reload_copy(test::sample) };
+
+  const auto renamed = _edit("reload-renamed.toml", "name = \"sample\"", "name = \"renamed\"");
+  handle.publish(reloader.reload_copy(renamed));
+  handle.reclaim();
+
+  std::string content = test::read(renamed);
+  content.replace(content.find("level = \"info\""), 14u, "level = \"warn\"");
+  const auto level = test::write("reload-level.toml", content);
+  auto cfg = reloader.reload_copy(level);
+  test::check(static_cast<bool>(cfg), "The configuration did not change");
+  _check_loaded(*cfg, level);
+  handle.publish(std::move(cfg));
+  handle.reclaim();
+
+  /* So is a configuration reloaded after it was handed over */
+  const auto file = _edit("reload-handed.toml", "path = \"/a\"", "path = \"/c\"");
+  const auto result = reloader.reload(file);
+  _check_loaded(*result.config, file);
+  _check_loaded(*reloader.reload(level).config, level);
+}
+
+static void
+_test_config_handle()
+{
+  const auto renamed = _edit("reload-handle.toml", "name = \"sample\"", "name = \"renamed\"");
+  protomodel::ConfigHandle handle{ std::make_unique<sample::ConfigT>(protomodel::load(test::sample)), 2u };
+  protomodel::ConfigHandle::Reader reader{ handle };
+
+  /* A snapshot keeps its configuration alive across publications */
+  {
+    const auto snapshot = reader.read();
+    handle.publish(std::make_unique<sample::ConfigT>(protomodel::load(renamed)));
+    handle.reclaim();
+    const auto nested = reader.read();
+    test::check((snapshot->name == "sample") && (nested->name == "renamed"),
+                "The snapshots do not hold their configuration");
+  }
+  test::check(reader.read()->name == "renamed", "The publication was not read");
+
+  {
+    protomodel::ConfigHandle::Reader other{ handle };
+    test::check_throws([&]() { protomodel::ConfigHandle::Reader third{ handle }; },
+                       "Registering more readers than slots");
+  }
+  {
+    /* The slot of a destroyed reader is reused */
+    protomodel::ConfigHandle::Reader third{ handle };
+  }
+
+  /* Readers see complete configurations while they are published */
+  std::atomic<bool> stop{ false };
+  std::atomic<bool> torn{ false };
+  std::thread thread{ [&]() {
+    protomodel::ConfigHandle::Reader thread_reader{ handle };
+    while (! stop.load())
+    {
+      const auto snapshot = thread_reader.read();
+      if ((snapshot->servers.size() != 3u) || (snapshot->routes[1]->weight == 0u))
+      { torn.store(true); }
+    }
+  } };
+  for (uint32_t i = 1u; i < 200u; i++)
+  {
+    auto cfg = std::make_unique<sample::ConfigT>(protomodel::load(test::sample));
+    cfg->routes[1]->weight = i;
+    handle.publish(std::move(cfg));
+  }
+  stop.store(true);
+  thread.join();
+  test::check(! torn.load(), "A reader saw an incomplete configuration");
+  test::check(reader.read()->routes[1]->weight == 199u, "The last publication was not read");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "reload", _test_reload },
+    { "reload_error", _test_reload_error },
+    { "reload_copy", _test_reload_copy },
+    { "reload_copy_published", _test_reload_copy_published },
+    { "config_handle", _test_config_handle },
+  });
+}
@@ -0,0 +1,105 @@
+/* Protomodel - MIT License */
+
+/*
+ * Shared memory: subscribers map the generation last published, switch to
+ * the next ones on refresh(), and keep reading the generation they map
+ * after it was superseded and unlinked.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "flatbuffers-pack.h"
+#include "shm-config.h"
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <string>
+#include <unistd.h>
+
+/* Segments of each test are named after the process, so runs do not clash */
+static std::string
+_segment(const std::string &test)
+{ return "protomodel-" + test + "-" + std::to_string(getpid()); }
+
+/* Tell whether the segment of the generation @p generation exists */
+static bool
+_has_generation(const std::string &name, uint64_t generation)
+{
+  try
+  {
+    boost::interprocess::shared_memory_object{
+      boost::interprocess::open_only, (name + "." + std::to_string(generation)).c_str(),
+      boost::interprocess::read_only };
+    return true;
+  }
+  catch (const boost::interprocess::interprocess_exception &)
+  { return false; }
+}
+
+static void
+_test_publish()
+{
+  const auto name = _segment("publish");
+  auto cfg = protomodel::load(test::sample);
+  {
+    protomodel::ShmPublisher publisher{ name };
+    test::check_throws([&]() { protomodel::ShmSubscriber{ name }; },
+                       "Subscribing before the first publication");
+
+    test::check(publisher.publish(cfg) == 1u, "The first generation is not 1");
+    protomodel::ShmSubscriber subscriber{ name, true };
+    test::check((subscriber.generation() == 1u) &&
+                (subscriber.config()->name()->str() == "sample") &&
+                (subscriber.config()->port() == 8080),
+                "The subscriber does not read the publication");
+    test::check(! subscriber.refresh(), "Refreshing an unchanged generation");
+
+    cfg.port = 9090;
+    test::check(publisher.publish(cfg) == 2u, "The generation was not incremented");
+    test::check(subscriber.refresh() && (subscriber.generation() == 2u) &&
+                (subscriber.config()->port() == 9090),
+                "The subscriber did not switch to the new generation");
+
+    /* Already packed flatbuffers are published as they are */
+    const auto buffer = protomodel::pack(protomodel::load(test::sample));
+    test::check(publisher.publish(buffer.data(), buffer.size()) == 3u, "The packed flatbuffer was not published");
+    test::check(subscriber.refresh() && (subscriber.config()->port() == 8080),
+                "The packed flatbuffer was not read");
+  }
+
+  /* A new publisher resumes after the last generation */
+  protomodel::ShmPublisher publisher{ name };
+  test::check(publisher.publish(cfg) == 4u, "The publisher did not resume the generations");
+  protomodel::ShmPublisher::remove(name);
+  test::check_throws([&]() { protomodel::ShmSubscriber{ name }; }, "Subscribing to removed segments");
+}
+
+static void
+_test_superseded()
+{
+  const auto name = _segment("superseded");
+  auto cfg = protomodel::load(test::sample);
+  protomodel::ShmPublisher publisher{ name };
+  publisher.publish(cfg);
+  const protomodel::ShmSubscriber stale{ name };
+
+  cfg.name = "next";
+  publisher.publish(cfg);
+  test::check(! _has_generation(name, 1u) && _has_generation(name, 2u),
+              "The superseded generation was not unlinked");
+
+  /* The unlinked generation stays mapped until it is released */
+  test::check((stale.generation() == 1u) && (stale.config()->name()->str() == "sample"),
+              "The superseded generation is not readable anymore");
+  protomodel::ShmPublisher::remove(name);
+  test::check(! _has_generation(name, 2u), "The segments were not removed");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "publish", _test_publish },
+    { "superseded", _test_superseded },
+  });
+}
@@ -0,0 +1,90 @@
+/* Protomodel - MIT License */
+
+/*
+ * Partial loads: a table loaded by load_subtree() must be the one a load of
+ * the whole file holds, whatever the parts of the file it skips contain.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "toml-loader-subtree.h"
+#include "object-compare.h"
+
+#include <string>
+
+static void
+_test_tables()
+{
+  const auto loaded = protomodel::load(test::sample);
+  test::check(protomodel::load_subtree<sample::LoggingT>(test::sample, "logging") == *loaded.logging,
+              "The object differs from a load");
+  test::check(protomodel::load_subtree<sample::ConfigT>(test::sample, "") == loaded,
+              "The root table differs from a load");
+
+  /* Map entries get their key from the path */
+  test::check(protomodel::load_subtree<sample::ServerT>(test::sample, "servers.alpha") ==
+              *protomodel::find_Config_servers(loaded, "alpha"),
+              "The map entry differs from a load");
+  const auto dot = protomodel::load_subtree<sample::ServerT>(test::sample, "servers.\"with.dot\"");
+  test::check((dot.name == "with.dot") && (dot.port == 3), "The quoted key was not loaded");
+}
+
+static void
+_test_skipped()
+{
+  /* Headers within strings, arrays and comments are skipped */
+  const auto file = test::write("subtree-skipped.toml",
+    "name = \"\"\"\n"
+    "[logging]\n"
+    "level = \"string\"\n"
+    "\"\"\"\n"
+    "levels = [\n"
+    "  1, # [logging]\n"
+    "  2,\n"
+    "]\n"
+    "tags = ['[logging]']\n"
+    "curve = [1.0]\n"
+    "ids = [1]\n"
+    "# [logging]\n"
+    "[[routes]]\n"
+    "path = \"/\"\n"
+    "[servers.s]\n"
+    "aliases = [\"a\"]\n"
+    "[logging]\n"
+    "level = \"table\"\n"
+    "[[logging.sinks]]\n"
+    "path = \"/sink\"\n");
+  const auto logging = protomodel::load_subtree<sample::LoggingT>(file, "logging");
+  test::check((logging.level == "table") && (logging.sinks.size() == 1u) &&
+              (logging.sinks[0]->path == "/sink"),
+              "The table was not extracted");
+  test::check(logging == *protomodel::load(file).logging, "The table differs from a load");
+}
+
+static void
+_test_errors()
+{
+  test::check_throws([]() { protomodel::load_subtree<sample::LoggingT>(test::sample, "nope"); },
+                     "Loading a missing table");
+  test::check_throws([]() { protomodel::load_subtree<sample::LoggingT>(test::sample, "name"); },
+                     "Loading a value as a table");
+  test::check_throws([]() { protomodel::load_subtree<sample::LoggingT>(test::sample, "a..b"); },
+                     "Loading an invalid path");
+  test::check_throws([]() { protomodel::load_subtree<sample::LoggingT>("subtree-missing.toml", "logging"); },
+                     "Loading a missing file");
+  test::check_throws([]() {
+    protomodel::load_subtree<sample::LoggingT>(
+      test::write("subtree-invalid.toml", test::minimal + "[logging]\nverbose = 3\n"), "logging");
+  }, "Loading an invalid table");
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "tables", _test_tables },
+    { "skipped", _test_skipped },
+    { "errors", _test_errors },
+  });
+}
@@ -0,0 +1,114 @@
+/* Protomodel - MIT License */
+
+#ifndef PROTOMODEL_TESTS_TEST_H__
+#define PROTOMODEL_TESTS_TEST_H__
+
+/*
+ * Minimal harness of the tests of the templates. A test program runs its
+ * cases in order, on the sample configuration given as its first argument,
+ * and fails at the first check that does not hold. Files written by the
+ * tests are created in their working directory.
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace test {
+
+/** Path to the sample configuration */
+inline std::string sample;
+
+/**
+ * Smallest configuration of the sample interface: its arrays and maps hold
+ * one element each, as the interface requires, and it has no logging table
+ */
+inline const std::string minimal{
+  "name = \"minimal\"\n"
+  "levels = [1]\n"
+  "tags = [\"t\"]\n"
+  "curve = [1.0]\n"
+  "ids = [1]\n"
+  "[[routes]]\n"
+  "path = \"/\"\n"
+  "[servers.s]\n"
+  "aliases = [\"a\"]\n"
+};
+
+/** Throw if @p condition does not hold */
+inline void
+check(bool condition, const std::string &what)
+{
+  if (! condition)
+  { throw std::runtime_error(what); }
+}
+
+/** Throw if @p func returns instead of throwing */
+template<typename Func>
+void
+check_throws(const Func &func, const std::string &what)
+{
+  try
+  { func(); }
+  catch (const std::exception &)
+  { return; }
+  throw std::runtime_error(what + " did not throw");
+}
+
+/** Write @p content to @p file and return the path to the file */
+inline std::string
+write(const std::string &file, const std::string &content)
+{
+  std::ofstream out{ file, std::ios::binary | std::ios::trunc };
+  out << content;
+  out.close();
+  check(static_cast<bool>(out), "Failed to write '" + file + "'");
+  return file;
+}
+
+/** Read the content of @p file */
+inline std::string
+read(const std::string &file)
+{
+  std::ifstream in{ file, std::ios::binary };
+  check(static_cast<bool>(in), "Failed to read '" + file + "'");
+  return std::string{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+}
+
+/** Test case: its name and the function running it */
+using Case = std::pair<const char *, void (*)()>;
+
+/** Run @p cases in order, on the sample configuration given by @p argv */
+inline int
+run(int argc, char **argv, std::initializer_list<Case> cases)
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <sample.toml>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  sample = argv[1];
+
+  for (const auto &test_case : cases)
+  {
+    try
+    { test_case.second(); }
+    catch (const std::exception &e)
+    {
+      std::cerr << "FAIL " << test_case.first << ": " << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "PASS " << test_case.first << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
+
+} /* namespace test */
+
+#endif /* ! PROTOMODEL_TESTS_TEST_H__ */
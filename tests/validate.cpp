@@ -0,0 +1,95 @@
+/* Protomodel - MIT License */
+
+/*
+ * Validation: validate() must accept the configurations load() accepts, and
+ * report every problem of the others, each at the path of its element.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "toml-loader-validate.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+static bool
+_has(const protomodel::ValidationResult &result, const std::string &path)
+{
+  return std::any_of(result.diagnostics.begin(), result.diagnostics.end(),
+                     [&](const protomodel::Diagnostic &diag) { return diag.path == path; });
+}
+
+static void
+_test_valid()
+{
+  const auto result = protomodel::validate(test::sample);
+  test::check(result.ok() && (result.file == test::sample), "The sample was rejected");
+  test::check(protomodel::validate(test::write("validate-minimal.toml", test::minimal)).ok(),
+              "The minimal configuration was rejected");
+}
+
+static void
+_test_all_problems()
+{
+  const auto file = test::write("validate-invalid.toml",
+    "unknown = 1\n"
+    "port = 4294967296\n"
+    "levels = [1, 3000000000]\n"
+    "tags = []\n"
+    "curve = [1.0]\n"
+    "ids = [1]\n"
+    "[logging]\n"
+    "verbose = 3\n"
+    "[[logging.sinks]]\n"
+    "size = -1\n"
+    "[[routes]]\n"
+    "path = \"/\"\n"
+    "[servers.s]\n"
+    "port = \"p\"\n"
+    "aliases = [\"a\"]\n");
+  const auto result = protomodel::validate(file);
+  for (const char *path : { "unknown", "name", "port", "levels[1]", "tags", "logging.verbose",
+                            "logging.sinks[0].size", "servers.s.port" })
+  { test::check(_has(result, path), std::string{ "No diagnostic for " } + path); }
+  test::check(result.diagnostics.size() == 8u, "Unexpected diagnostics");
+  test::check_throws([&]() { protomodel::load(file); }, "Loading the invalid configuration");
+}
+
+static void
+_test_parse_error()
+{
+  const auto result = protomodel::validate(test::write("validate-syntax.toml", "name = \n"));
+  test::check((result.diagnostics.size() == 1u) && result.diagnostics[0].path.empty(),
+              "The parse error was not reported for the file");
+  test::check(! protomodel::validate("validate-missing.toml").ok(), "A missing file was accepted");
+}
+
+static void
+_test_validate_many()
+{
+  const std::vector<std::string> files{
+    test::sample,
+    test::write("validate-many.toml", "port = 1\n"),
+    test::write("validate-many-minimal.toml", test::minimal),
+  };
+  const auto results = protomodel::validate_many(files, 0u);
+  test::check(results.size() == files.size(), "Files were not all validated");
+  for (size_t i = 0u; i < files.size(); i++)
+  {
+    test::check(results[i].file == files[i], "The results are not in the order of the files");
+    test::check(results[i].ok() == (i != 1u), "A file was not validated as it was loaded");
+  }
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "valid", _test_valid },
+    { "all_problems", _test_all_problems },
+    { "parse_error", _test_parse_error },
+    { "validate_many", _test_validate_many },
+  });
+}
@@ -0,0 +1,94 @@
+/* Protomodel - MIT License */
+
+/*
+ * Writer: the documents written from a configuration must load back into
+ * the same configuration, whatever the values of its strings and numbers.
+ */
+
+#include "test.h"
+#include "toml-loader.h"
+#include "toml-generator.h"
+#include "toml-writer.h"
+#include "object-compare.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+static void
+_test_sample()
+{
+  const auto cfg = protomodel::load(test::sample);
+  protomodel::TomlWriter writer;
+  test::check(protomodel::load_from_buffer(writer.dump(cfg)) == cfg, "The sample did not round trip");
+
+  /* All the outputs write the same document */
+  const std::string doc = writer.dump(cfg);
+  std::ostringstream stream;
+  writer.dump(cfg, stream);
+  protomodel::dump(cfg, stream);
+  test::check(stream.str() == doc + doc, "The stream differs from the string");
+
+  const int fd = open("writer-fd.toml", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  test::check(fd >= 0, "Failed to open writer-fd.toml");
+  protomodel::dump(cfg, fd);
+  close(fd);
+  test::check(test::read("writer-fd.toml") == doc, "The file differs from the string");
+}
+
+static void
+_test_values()
+{
+  auto cfg = protomodel::load(test::sample);
+  cfg.name = std::string{ "quote\" backslash\\ tab\t newline\n nul" } + '\0' + " del\x7f";
+  cfg.tags = { "", "\xc3\xa9t\xc3\xa9", "[not] = \"a table\"" };
+  cfg.port = std::numeric_limits<int32_t>::min();
+  cfg.ratio = 0.1;
+  cfg.curve = { std::numeric_limits<float>::max(), -0.0f, 1e-30f };
+  cfg.ids = { 0u, static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) };
+  cfg.routes[0]->prio = std::numeric_limits<int64_t>::min();
+  cfg.servers[0]->name = "a \"quoted\" key"; /* Still the first one */
+
+  protomodel::TomlWriter writer{ 16u };
+  test::check(protomodel::load_from_buffer(writer.dump(cfg)) == cfg,
+              "The values did not round trip through a small buffer");
+
+  /* TOML integers cannot hold the largest unsigned values */
+  cfg.ids.push_back(std::numeric_limits<uint64_t>::max());
+  test::check_throws([&]() { writer.dump(cfg); }, "Writing an unsigned value above INT64_MAX");
+}
+
+static void
+_test_generated()
+{
+  protomodel::GeneratorOptions options;
+  options.scale = 30u;
+  protomodel::TomlWriter writer;
+  for (options.seed = 0u; options.seed < 10u; options.seed++)
+  {
+    std::FILE *const out = std::fopen("writer-generated.toml", "wb");
+    test::check(out != nullptr, "Failed to open writer-generated.toml");
+    protomodel::generate(options, out);
+    test::check(std::fclose(out) == 0, "Failed to write writer-generated.toml");
+
+    const auto cfg = protomodel::load("writer-generated.toml");
+    test::check(protomodel::load_from_buffer(writer.dump(cfg)) == cfg,
+                "The configuration of seed " + std::to_string(options.seed) + " did not round trip");
+  }
+}
+
+int
+main(int argc,
+     char **argv)
+{
+  return test::run(argc, argv, {
+    { "sample", _test_sample },
+    { "values", _test_values },
+    { "generated", _test_generated },
+  });
+}